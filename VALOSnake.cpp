@@ -2,6 +2,9 @@
 #include <vector>
 #include <cstdlib>
 #include <ctime>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <string>
 #include <algorithm>
 #include <windows.h>
@@ -488,27 +491,304 @@ public:
     }
 };
 
+// 浵ļڴӳ׷ʽ¼ļ
+// : [ļͷ HEADER_BYTES ֽ: ħ + ύͷ][Ծּ¼ SessionRecord ...]
+// ͷ۱ϡύ¼ǰ TOP_N ʱֻУͷۣɨʷ¼
+const uint32_t SAVE_MAGIC = 0x4B414E53;    // "SNAK"
+const uint32_t SAVE_VERSION = 1;
+const int TOP_N = 5;                       // ÿаĿ
+const int ROLE_COUNT = 3;                  // ɫ Role öһ£
+const int BOARD_COUNT = 1 + ROLE_COUNT;    // ܰ + ÿɫһ
+const uint64_t HEADER_BYTES = 4096;        // ¼ʼƫ
+const uint64_t INITIAL_RECORDS = 1024;     // ´浵Ԥļ¼
+
+// аĿ
+struct ScoreEntry {
+    int32_t score;
+    uint32_t recordIndex;   // ӦĶԾּ¼
+};
+
+// ּ¼̶ȣֻ׷ӣ
+struct SessionRecord {
+    int64_t endTime;        // ʱ time(0)
+    int32_t score;
+    int32_t role;
+};
+
+// ͷۣһύ
+struct HeaderSlot {
+    uint64_t sequence;                      // ύţϴΪ
+    uint64_t recordCount;                   // ύļ¼
+    int32_t highScore;
+    int32_t points;
+    uint8_t unlockedClear;
+    uint8_t unlockedRevive;
+    uint8_t reserved[2];
+    uint32_t topCount[BOARD_COUNT];         // ÿЧĿ
+    ScoreEntry top[BOARD_COUNT][TOP_N];     // [0] ܰ, [1 + role] ɫ
+    uint32_t checksum;                      // ֶε FNV-1a У
+};
+
+struct SaveHeader {
+    uint32_t magic;
+    uint32_t version;
+    HeaderSlot slots[2];
+};
+
+// а洢
+// ύ˳д벢ˢ¼¼дǻͷ۲ˢ£ʱඪʧδύһ
+class ProfileStore {
+private:
+    HANDLE file;
+    HANDLE mapping;
+    char* view;
+    uint64_t capacity;      // ǰӳֽ
+    int activeSlot;         // һύڵͷ
+    HeaderSlot current;     // һύ
+
+    static uint32_t computeChecksum(const HeaderSlot& slot) {
+        const unsigned char* p = (const unsigned char*)&slot;
+        uint32_t h = 2166136261u;
+        for (size_t i = 0; i < offsetof(HeaderSlot, checksum); i++) {
+            h = (h ^ p[i]) * 16777619u;
+        }
+        return h;
+    }
+
+    // 񵥣ͬʱȴǰ
+    static void insertTop(uint32_t& count, ScoreEntry* list, const ScoreEntry& entry) {
+        uint32_t pos = 0;
+        while (pos < count && list[pos].score >= entry.score) pos++;
+        if (pos >= (uint32_t)TOP_N) return;
+        uint32_t last = count < (uint32_t)TOP_N ? count : TOP_N - 1;
+        for (uint32_t i = last; i > pos; i--) list[i] = list[i - 1];
+        list[pos] = entry;
+        if (count < (uint32_t)TOP_N) count++;
+    }
+
+    SaveHeader* header() const {
+        return (SaveHeader*)view;
+    }
+
+    static uint64_t recordOffset(uint64_t index) {
+        return HEADER_BYTES + index * sizeof(SessionRecord);
+    }
+
+    // ָСӳļļʱϵͳչ
+    bool mapView(uint64_t bytes) {
+        if (view) UnmapViewOfFile(view);
+        if (mapping) CloseHandle(mapping);
+        view = NULL;
+        mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE, (DWORD)(bytes >> 32), (DWORD)bytes, NULL);
+        if (!mapping) return false;
+        view = (char*)MapViewOfFile(mapping, FILE_MAP_ALL_ACCESS, 0, 0, 0);
+        if (!view) {
+            CloseHandle(mapping);
+            mapping = NULL;
+            return false;
+        }
+        capacity = bytes;
+        return true;
+    }
+
+    // ֤׷һ¼
+    bool reserveRecord() {
+        uint64_t needed = recordOffset(current.recordCount + 1);
+        if (needed <= capacity) return true;
+        uint64_t newCapacity = capacity * 2;
+        if (newCapacity < needed) newCapacity = needed;
+        return mapView(newCapacity);
+    }
+
+    void flush(uint64_t offset, uint64_t bytes) {
+        FlushViewOfFile(view + offset, (SIZE_T)bytes);
+        FlushFileBuffers(file);
+    }
+
+    //  current дǻͷ۲лɹͷΪ
+    void commit() {
+        current.sequence++;
+        current.highScore = highScore;
+        current.points = points;
+        current.unlockedClear = unlockedClear ? 1 : 0;
+        current.unlockedRevive = unlockedRevive ? 1 : 0;
+        current.checksum = computeChecksum(current);
+        if (!view) return;
+
+        int target = 1 - activeSlot;
+        header()->slots[target] = current;
+        flush(offsetof(SaveHeader, slots) + target * sizeof(HeaderSlot), sizeof(HeaderSlot));
+        activeSlot = target;
+    }
+
+    // ȡµЧͷۣ¼¼ͷΪЧ
+    void load(uint64_t fileSize) {
+        SaveHeader* h = header();
+        if (fileSize < HEADER_BYTES || h->magic != SAVE_MAGIC || h->version != SAVE_VERSION) {
+            memset(h, 0, sizeof(SaveHeader));
+            h->magic = SAVE_MAGIC;
+            h->version = SAVE_VERSION;
+            flush(0, sizeof(SaveHeader));
+            return;
+        }
+
+        int best = -1;
+        for (int i = 0; i < 2; i++) {
+            const HeaderSlot& slot = h->slots[i];
+            if (slot.checksum != computeChecksum(slot)) continue;
+            if (recordOffset(slot.recordCount) > fileSize) continue;
+            if (best < 0 || slot.sequence > h->slots[best].sequence) best = i;
+        }
+        if (best < 0) return;
+
+        activeSlot = best;
+        current = h->slots[best];
+        highScore = current.highScore;
+        points = current.points;
+        unlockedClear = current.unlockedClear != 0;
+        unlockedRevive = current.unlockedRevive != 0;
+    }
+
+    void close() {
+        if (view) UnmapViewOfFile(view);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        view = NULL;
+        mapping = NULL;
+        file = INVALID_HANDLE_VALUE;
+    }
+
+public:
+    int highScore;          // ʷ߷
+    int points;             // һ֣ڽɫ
+    bool unlockedClear;     // Ƿѽ
+    bool unlockedRevive;    // Ƿѽ
+
+    // 򿪴浵޷ʱ˻Ϊڴ汣棨Ч
+    ProfileStore(const char* path) : file(INVALID_HANDLE_VALUE), mapping(NULL), view(NULL), capacity(0), activeSlot(1),
+        highScore(0), points(0), unlockedClear(false), unlockedRevive(false) {
+        memset(&current, 0, sizeof(current));
+
+        file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, NULL, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+        if (file == INVALID_HANDLE_VALUE) return;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size)) { close(); return; }
+        uint64_t fileSize = (uint64_t)size.QuadPart;
+        uint64_t initialBytes = recordOffset(INITIAL_RECORDS);
+        if (!mapView(fileSize > initialBytes ? fileSize : initialBytes)) { close(); return; }
+
+        load(fileSize);
+    }
+
+    ~ProfileStore() {
+        close();
+    }
+
+    // Ƿѳ־û
+    bool isPersistent() const {
+        return view != NULL;
+    }
+
+    // ¼һ֣߷֡а񣬲Ϊһύд浵
+    void recordSession(int score, Role role) {
+        if (score > highScore) highScore = score;
+        if (score > 0) points += score;
+
+        ScoreEntry entry;
+        entry.score = score;
+        entry.recordIndex = (uint32_t)current.recordCount;
+        insertTop(current.topCount[0], current.top[0], entry);
+        insertTop(current.topCount[1 + role], current.top[1 + role], entry);
+
+        if (view && reserveRecord()) {
+            SessionRecord record;
+            record.endTime = (int64_t)time(0);
+            record.score = score;
+            record.role = role;
+            uint64_t offset = recordOffset(current.recordCount);
+            memcpy(view + offset, &record, sizeof(record));
+            flush(offset, sizeof(record));
+        }
+        current.recordCount++;
+        commit();
+    }
+
+    // ϱ仯̵깺
+    void saveProfile() {
+        if (current.highScore == highScore && current.points == points &&
+            (current.unlockedClear != 0) == unlockedClear && (current.unlockedRevive != 0) == unlockedRevive) {
+            return;
+        }
+        commit();
+    }
+
+    // ʷܾ
+    uint64_t getSessionCount() const {
+        return current.recordCount;
+    }
+
+    // ܰĿĿ
+    int getTopCount() const {
+        return (int)current.topCount[0];
+    }
+    const ScoreEntry& getTopEntry(int rank) const {
+        return current.top[0][rank];
+    }
+
+    // ɫĿĿ
+    int getRoleTopCount(Role role) const {
+        return (int)current.topCount[1 + role];
+    }
+    const ScoreEntry& getRoleTopEntry(Role role, int rank) const {
+        return current.top[1 + role][rank];
+    }
+};
+
 // Ϸ˵ѡ: 1-¿ʼ, 2-̵, 3-˳
-int showEndGameMenu(int currentScore, int& highScore, int& points) {
+int showEndGameMenu(int currentScore, Role role, ProfileStore& store) {
     system("cls");
     cout << "\n" << string(15, '=') << " Ϸ " << string(15, '=') << "\n\n";
     cout << "ֵ÷: " << currentScore << endl;
-    
+
+    // ¼ֲ浵ͬʱ߷֡а
+    bool newRecord = currentScore > store.highScore;
+    store.recordSession(currentScore, role);
+
     // ʷ߷
-    if (currentScore > highScore) {
-        highScore = currentScore;
-        cout << "µ߼¼! ߵ÷: " << highScore << endl;
+    if (newRecord) {
+        cout << "µ߼¼! ߵ÷: " << store.highScore << endl;
     } else {
-        cout << "ʷߵ÷: " << highScore << endl;
+        cout << "ʷߵ÷: " << store.highScore << endl;
     }
 
     // ÷תΪ֣1 = 1֣
     if (currentScore > 0) {
-        points += currentScore;
         cout << "ֵ÷תΪ: +" << currentScore << " \n";
-        cout << "ǰܻ: " << points << "\n";
+        cout << "ǰܻ: " << store.points << "\n";
     }
-    
+    if (!store.isPersistent()) {
+        cout << "޷򿪴浵 save.datνȲᱣ棩\n";
+    }
+
+    // аֱӶȡ浵ɨʷ¼
+    cout << "\nа񣨹 " << store.getSessionCount() << " ֣:\n";
+    for (int i = 0; i < store.getTopCount(); i++) {
+        const ScoreEntry& e = store.getTopEntry(i);
+        cout << "  " << (i + 1) << ". " << e.score << "   ( " << (e.recordIndex + 1) << " )\n";
+    }
+    string roleName;
+    switch (role) {
+        case NORMAL_ROLE: roleName = "̰"; break;
+        case CLEAR_ROLE: roleName = ""; break;
+        case REVIVE_ROLE: roleName = ""; break;
+    }
+    cout << roleName << " а:\n";
+    for (int i = 0; i < store.getRoleTopCount(role); i++) {
+        const ScoreEntry& e = store.getRoleTopEntry(role, i);
+        cout << "  " << (i + 1) << ". " << e.score << "   ( " << (e.recordIndex + 1) << " )\n";
+    }
+
     cout << "\n" << string(40, '-') << "\n";
     cout << "ѡ:\n";
     cout << "  1 - ¿ʼ\n";
@@ -630,30 +910,33 @@ int main() {
     cout << ": Kʹ\n";
     system("pause");
     
-    int highScore = 0;  // ¼ʷ߷
+    ProfileStore store("save.dat");  // 浵֡״̬а
+    int& highScore = store.highScore;  // ¼ʷ߷
     bool continueGame = true;
-    int points = 0;                  // һ֣ڽɫ
-    bool unlockedClear = false;      // Ƿѽ
-    bool unlockedRevive = false;     // Ƿѽ
+    int& points = store.points;                  // һ֣ڽɫ
+    bool& unlockedClear = store.unlockedClear;   // Ƿѽ
+    bool& unlockedRevive = store.unlockedRevive; // Ƿѽ
 
     while (continueGame) {
         system("cls");  // ֮ǰϷص
 
         // ɫѡ񣨵ö chooseRole
         Role selectedRole = chooseRole(points, unlockedClear, unlockedRevive);
+        store.saveProfile(); // ɫѡ̵Ĺ
         system("cls"); // ɫѡ
 
         SnakeGame game(selectedRole);
         game.run();
 
         // Ϸ󽫵÷תΪֲʾ̵ѡ
-        int menuChoice = showEndGameMenu(game.getScore(), highScore, points);
+        int menuChoice = showEndGameMenu(game.getScore(), selectedRole, store);
         if (menuChoice == 1) {
             continueGame = true; // ¿ʼ
             continue;
         } else if (menuChoice == 2) {
             // ̵
             showShop(points, unlockedClear, unlockedRevive);
+            store.saveProfile();
             // ̵صѭɫѡ
             continueGame = true;
             continue;